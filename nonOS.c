@@ -5,6 +5,7 @@
 #include "nonOS_common.h"
 #include "os_cpu.h"
 #include "smart_memory.h"
+#include "smart_arena.h"
 
 struct NOS_Msg_t
 {
@@ -73,11 +74,14 @@ struct NOS_Stack_t
 *
 * Return		: None.
 *
-* Note(s)   	: None.
+* Note(s)   	: (1) Placement policy: the hot objects of OS (Tcb, stack frame, event and msg node) are
+*					  calloced by __Nos_Mem_callocHot() from MEM_REGION_Fast, the bulk buffers (such as
+*					  the copy of msg) are malloced from MEM_REGION_Slow.
 *
 *********************************************************************************************************/
 #define __Nos_Mem_malloc					Mem_malloc
 #define __Nos_Mem_calloc					Mem_calloc
+#define __Nos_Mem_callocHot(nSize)			Mem_callocIn(MEM_REGION_Fast, nSize)
 #define __Nos_Mem_relloc					Mem_relloc
 #define __Nos_Mem_free						Mem_free
 
@@ -360,7 +364,7 @@ static int nos_runWakeupTask(int nInx)
 		}
 		if(b_created == 0)
 		{
-			struct NOS_TaskInxList_t *ele_new = __Nos_Mem_calloc(sizeof(struct NOS_TaskInxList_t));
+			struct NOS_TaskInxList_t *ele_new = __Nos_Mem_callocHot(sizeof(struct NOS_TaskInxList_t));
 			if(ele_new != NULL)
 			{
 				ele_new->nInx = nInx;
@@ -511,7 +515,7 @@ void nos_renewEvtTimeoutList(struct NOS_Evt_t* pEvt, NOS_TASKNUM nTaskPrio, NOS_
 
 	if(b_created == 0) // Has not been created, create a new one.
 	{
-		struct NOS_Evt_Timeout_t *ele_new = __Nos_Mem_calloc(sizeof(struct NOS_Evt_Timeout_t));
+		struct NOS_Evt_Timeout_t *ele_new = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_Timeout_t));
 		if(ele_new != NULL)
 		{
 			ele_new->nTick = nTimeout;
@@ -581,7 +585,7 @@ int nos_sendEvt(struct NOS_Evt_t *pEvt, enum NOS_Msg_e eMsgType, void *pMsg)
 					}	
 					if(wait_cnt > 0) // Only if any task is waitting for this msg will sent.
 					{
-						struct NOS_Evt_MsgBox_t *msgbox = __Nos_Mem_calloc(sizeof(struct NOS_Evt_MsgBox_t));
+						struct NOS_Evt_MsgBox_t *msgbox = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_MsgBox_t));
 						if(msgbox != NULL)
 						{
 							msgbox->nWaitTaskCnt = wait_cnt;
@@ -676,7 +680,7 @@ int nos_waitEvt(struct NOS_Evt_t* pEvt, NOS_TICK nTimeout, void ** pMsgAddr)
 								if(pMsgAddr != NULL) // get the msg and its type.
 								{
 									ret = NOS_ERROR_None;
-									(*pMsgAddr) = Mem_malloc(msgbox->p1stSend->sMsg.nLength);
+									(*pMsgAddr) = __Nos_Mem_malloc(msgbox->p1stSend->sMsg.nLength);
 									if((*pMsgAddr) != NULL)
 									{
 										memmove((*pMsgAddr), msgbox->p1stSend->sMsg.pData, msgbox->p1stSend->sMsg.nLength);
@@ -755,7 +759,7 @@ int nos_storeStackValue(struct NOS_Tcb_t *pCurTcb, const void* pVars, int nCount
   {
     if(pCurTcb->pStack == NULL)
     {
-      pCurTcb->pStack = __Nos_Mem_calloc(sizeof(struct NOS_Stack_t) + nCountOfBytes);
+      pCurTcb->pStack = __Nos_Mem_callocHot(sizeof(struct NOS_Stack_t) + nCountOfBytes);
       if(pCurTcb->pStack == NULL)
       {
         return NOS_ERROR_NullMemory;
@@ -837,7 +841,7 @@ struct NOS_InnerMgr_t *NOS_getInnerMgr(void)
 	
 	if(s_instance.bInited == 0)
 	{
-		s_instance.pWakeupTaskInxList = __Nos_Mem_calloc(sizeof(struct NOS_TaskInxList_t));
+		s_instance.pWakeupTaskInxList = __Nos_Mem_callocHot(sizeof(struct NOS_TaskInxList_t));
 		
 		s_instance.bInited = 1;
 	}
@@ -885,7 +889,7 @@ int NOS_createTask(NOS_Task pTask, void* pUser, NOS_TASKNUM nPrio)
   if(task_mgr->nTaskAll <= NOS_MAX_TASKNUM)
   {
     ret = NOS_ERROR_NullMemory;
-    task_tcb = Mem_calloc(sizeof(struct NOS_Tcb_t));
+    task_tcb = __Nos_Mem_callocHot(sizeof(struct NOS_Tcb_t));
     if(task_tcb != NULL) 
     {
       task_tcb->nPrio = nPrio;
@@ -972,6 +976,13 @@ int NOS_deleteTask(NOS_TASKNUM nPrio)
 
   if(task_tcb != NULL)
   {	
+		while(task_tcb->pArenaList != NULL) // Release the arenas that task owns.
+		{
+			struct Arena_t *arena_cur = task_tcb->pArenaList;
+			task_tcb->pArenaList = arena_cur->pNext;
+			Arena_release(arena_cur);
+			arena_cur->pNext = NULL;
+		}
 		memset(task_tcb->pStack->arrStack, 0, (task_tcb->pStack->nStack));
 		Mem_free(task_tcb->pStack);
 		memset(task_tcb, 0, sizeof(struct NOS_Tcb_t));
@@ -981,6 +992,43 @@ int NOS_deleteTask(NOS_TASKNUM nPrio)
 	return nRet;
 }
 
+/*
+*********************************************************************************************************
+* Description	: This function attach an arena to the running task, so the arena is released when the
+*				  task is deleted.
+*
+* Arguments  	: pArena					Pointer of arena inited by Arena_init().
+*
+* Return		: NOS_ERROR_None			No error.
+*				  NOS_ERROR_NullPointer		Pointer of arena is null.
+*				  NOS_ERROR_NullTcb			No task is running.
+*
+* Note(s)   	: (1) Call it in task, the arena struct itself should live longer than the task.
+*
+*				  (2) NOS_deleteTask() calls Arena_release() for each attached arena.
+*
+*********************************************************************************************************/
+int NOS_attachArena(struct Arena_t *pArena)
+{
+	struct NOS_InnerMgr_t *task_mgr = NOS_getInnerMgr();
+
+	if(pArena == NULL)
+	{
+		return NOS_ERROR_NullPointer;
+	}
+	if(task_mgr->pCurTcb == NULL)
+	{
+		return NOS_ERROR_NullTcb;
+	}
+
+	__NOS_lockTaskMgr();
+	pArena->pNext = task_mgr->pCurTcb->pArenaList;
+	task_mgr->pCurTcb->pArenaList = pArena;
+	__NOS_unlockTaskMgr();
+
+	return NOS_ERROR_None;
+}
+
 /*
 *********************************************************************************************************
 * Description	: this function create an event by user.
@@ -1019,16 +1067,16 @@ int NOS_createEvt(enum NOS_EvtType_e eType, struct NOS_Evt_t **pEvtAddr, void* p
 	(*pEvtAddr) = NULL;
 	__NOS_lockTaskMgr();
 	ret = NOS_ERROR_NullMemory;
-  evt = __Nos_Mem_calloc(sizeof(struct NOS_Evt_t));
+  evt = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_t));
 	if(evt != NULL)
 	{
 		evt->pAddr = pEvtAddr;
-		evt->pTimeout = __Nos_Mem_calloc(sizeof(struct NOS_Evt_Timeout_t));
+		evt->pTimeout = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_Timeout_t));
 		switch(eType)
 		{
 			case NOS_EVT_Sem:
 				{
-					struct NOS_Evt_Sem_t *pSem = __Nos_Mem_calloc(sizeof(struct NOS_Evt_Sem_t));
+					struct NOS_Evt_Sem_t *pSem = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_Sem_t));
 					if(pSem != NULL)
 					{
 						pSem->nSemFree = (int)pOthers; // number of sem.
@@ -1038,7 +1086,7 @@ int NOS_createEvt(enum NOS_EvtType_e eType, struct NOS_Evt_t **pEvtAddr, void* p
 				break;
 			case NOS_EVT_MsgBox:
 				{
-					struct NOS_Evt_MsgBox_t *pMsgBox = __Nos_Mem_calloc(sizeof(struct NOS_Evt_MsgBox_t));
+					struct NOS_Evt_MsgBox_t *pMsgBox = __Nos_Mem_callocHot(sizeof(struct NOS_Evt_MsgBox_t));
 					if(pMsgBox != NULL)
 					{
 						obj = pMsgBox;
@@ -1140,7 +1188,7 @@ int NOS_delayTick(NOS_TICK nTick, NOS_Func func)
 	task_mgr->bRunning = 0;
 	task_mgr->bPending = 1;
 	task_mgr->nDelayTickCnt = nTick;
-	task_mgr->pWakeupTaskInxList = __Nos_Mem_calloc(sizeof(struct NOS_TaskInxList_t));
+	task_mgr->pWakeupTaskInxList = __Nos_Mem_callocHot(sizeof(struct NOS_TaskInxList_t));
 	__NOS_unlockTaskMgr();
 	
 	while(task_mgr->nDelayTickCnt > 0)
@@ -75,11 +75,13 @@ struct NOS_Tcb_t
   struct NOS_Evt_t*				pEvtWait;											// Pointer of event that task waitting.
   struct NOS_Stack_t*           pStack;												// Pointer of Stack of task, which will be stored
 																					// when pends up, restored when resumes.
+  struct Arena_t*				pArenaList;											// List of arenas released when task is deleted.
   struct NOS_Tcb_t*             pNext;												// Pointer of Next Task's Tcb.
 };
 
 struct NOS_Tcb_t;
 struct NOS_Evt_t;
+struct Arena_t;
 struct NOS_InnerMgr_t *NOS_getInnerMgr(void);
 
 /*
@@ -297,6 +299,7 @@ int 	nos_restoreStackValue(struct NOS_Tcb_t *pCurTcb, void* pVarsEnd);
 
 int 	NOS_createTask(NOS_Task pTask, void* pUser, NOS_TASKNUM nPrio);
 int 	NOS_deleteTask(NOS_TASKNUM nPrio);
+int 	NOS_attachArena(struct Arena_t *pArena);
 int 	NOS_createEvt(enum NOS_EvtType_e eType, struct NOS_Evt_t **pEvtAddr, void* pOthers);
 int 	NOS_deleteEvt(struct NOS_Evt_t **pEvtAddr);
 int 	NOS_delayTick(NOS_TICK nTick, NOS_Func func);
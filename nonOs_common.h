@@ -6,7 +6,7 @@
 typedef int8_t     	NOS_TASKNUM;
 typedef int32_t	    NOS_TICK;
 typedef uint32_t    NOS_MEMORY_SIZE;
-typedef uint32_t    NOS_MEMORY_ADDR;
+typedef uintptr_t   NOS_MEMORY_ADDR;
 
 
 #endif
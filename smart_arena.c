@@ -0,0 +1,173 @@
+#include "smart_arena.h"
+
+#include <stdio.h>
+#include <string.h>
+
+struct ArenaChunk_t
+{
+	struct ArenaChunk_t*			pNext;									// Pointer of next chunk.
+	uint32_t						nSize;									// Size of space of chunk.
+	uint32_t						nUsed;									// Size of space bumped.
+};
+
+/*
+*********************************************************************************************************
+* Description	: this function init an arena, no memory is malloced until the first Arena_malloc().
+*
+* Arguments  	: pArena					Pointer of arena.
+*				  eRegion					Region where chunks are malloced, see enum Mem_Region_e.
+*				  nChunkSize				Size of each chunk.
+*
+* Return		: return (0) if init success or (-1) if not.
+*
+* Note(s)   	: (1) the arena struct itself is owned by user, such as a static variable.
+*
+*********************************************************************************************************
+*/
+int Arena_init(struct Arena_t *pArena, enum Mem_Region_e eRegion, uint32_t nChunkSize)
+{
+	if((pArena == NULL) || (nChunkSize == 0)) return -1;
+
+	pArena->pChunkList = NULL;
+	pArena->nChunkSize = (nChunkSize + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	pArena->eRegion = eRegion;
+	pArena->pNext = NULL;
+	return 0;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function malloc a memory by bumping the pointer of current chunk.
+*
+* Arguments  	: pArena					Pointer of arena.
+*				  nSize						Size of memory user needs.
+*
+* Return		: return address of memory or NULL if smart_memory has not enough space.
+*
+* Note(s)   	: (1) the memory can not be freed one by one, use Arena_reset() or Arena_release() to
+*					  give back all of them at the end of a cycle.
+*
+*				  (2) if current chunk is not large enough, a new chunk is malloced and becomes the head,
+*					  size larger than nChunkSize gets a chunk of its own.
+*
+*********************************************************************************************************
+*/
+void *Arena_malloc(struct Arena_t *pArena, uint32_t nSize)
+{
+	struct ArenaChunk_t *chunk_cur;
+	void *ret_memory;
+
+	if((pArena == NULL) || (nSize == 0)) return NULL;
+
+	nSize = (nSize + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+	chunk_cur = pArena->pChunkList;
+	if((chunk_cur == NULL) || (chunk_cur->nSize - chunk_cur->nUsed < nSize))
+	{
+		uint32_t size_chunk = (nSize > pArena->nChunkSize)? nSize: pArena->nChunkSize;
+		chunk_cur = Mem_mallocIn(pArena->eRegion, sizeof(struct ArenaChunk_t) + size_chunk);
+		if(chunk_cur == NULL) return NULL;
+		chunk_cur->nSize = size_chunk;
+		chunk_cur->nUsed = 0;
+		chunk_cur->pNext = pArena->pChunkList;
+		pArena->pChunkList = chunk_cur;
+	}
+	ret_memory = (uint8_t *)&(chunk_cur[1]) + chunk_cur->nUsed;
+	chunk_cur->nUsed += nSize;
+
+	return ret_memory;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function calloc a memory from arena.
+*
+* Arguments  	: pArena					Pointer of arena.
+*				  nSize						Size of memory user needs.
+*
+* Return		: return address of memory or NULL if smart_memory has not enough space.
+*
+* Note(s)   	: None.
+*
+*********************************************************************************************************
+*/
+void *Arena_calloc(struct Arena_t *pArena, uint32_t nSize)
+{
+	void *ret_memory = Arena_malloc(pArena, nSize);
+	if(ret_memory != NULL)
+	{
+		memset(ret_memory, 0, nSize);
+	}
+	return ret_memory;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function give back all memory of arena but keep one chunk for the next cycle.
+*
+* Arguments  	: pArena					Pointer of arena.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) the kept chunk is one of nChunkSize, chunks for large size are freed to smart_memory,
+*					  so a steady cycle needs no Mem_malloc() after the first one.
+*
+*********************************************************************************************************
+*/
+void Arena_reset(struct Arena_t *pArena)
+{
+	struct ArenaChunk_t *chunk_cur;
+	struct ArenaChunk_t *chunk_keep = NULL;
+
+	if(pArena == NULL) return;
+
+	chunk_cur = pArena->pChunkList;
+	while(chunk_cur != NULL)
+	{
+		struct ArenaChunk_t *chunk_next = chunk_cur->pNext;
+		if((chunk_keep == NULL) && (chunk_cur->nSize == pArena->nChunkSize))
+		{
+			chunk_keep = chunk_cur;
+		}
+		else
+		{
+			Mem_free(chunk_cur);
+		}
+		chunk_cur = chunk_next;
+	}
+	if(chunk_keep != NULL)
+	{
+		chunk_keep->nUsed = 0;
+		chunk_keep->pNext = NULL;
+	}
+	pArena->pChunkList = chunk_keep;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function give back all memory of arena to smart_memory.
+*
+* Arguments  	: pArena					Pointer of arena.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) the arena can still be used after release, it will malloc a new chunk when needed.
+*
+*				  (2) NOS_deleteTask() will call it for the arenas attached to the task.
+*
+*********************************************************************************************************
+*/
+void Arena_release(struct Arena_t *pArena)
+{
+	struct ArenaChunk_t *chunk_cur;
+
+	if(pArena == NULL) return;
+
+	chunk_cur = pArena->pChunkList;
+	while(chunk_cur != NULL)
+	{
+		struct ArenaChunk_t *chunk_next = chunk_cur->pNext;
+		Mem_free(chunk_cur);
+		chunk_cur = chunk_next;
+	}
+	pArena->pChunkList = NULL;
+}
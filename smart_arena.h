@@ -0,0 +1,25 @@
+#ifndef _SMART_ARENA_H_
+#define	_SMART_ARENA_H_
+
+#include <stdint.h>
+#include "smart_memory.h"
+
+#define ARENA_ALIGN					4			// Align bytes of each arena allocation.
+
+struct ArenaChunk_t;
+
+struct Arena_t
+{
+	struct ArenaChunk_t*			pChunkList;								// List of chunks, the head is the one to bump.
+	uint32_t						nChunkSize;								// Size of each chunk malloced from smart_memory.
+	enum Mem_Region_e				eRegion;								// Region where chunks are malloced.
+	struct Arena_t*					pNext;									// Pointer of next arena owned by the same task.
+};
+
+int Arena_init(struct Arena_t *pArena, enum Mem_Region_e eRegion, uint32_t nChunkSize);
+void *Arena_malloc(struct Arena_t *pArena, uint32_t nSize);
+void *Arena_calloc(struct Arena_t *pArena, uint32_t nSize);
+void Arena_reset(struct Arena_t *pArena);
+void Arena_release(struct Arena_t *pArena);
+
+#endif
@@ -2,6 +2,9 @@
 
 #include <stdio.h>
 #include <string.h>
+#if MEM_CFG_THREAD_CACHE
+#include <pthread.h>
+#endif
 
 struct MemBlock_t
 {
@@ -15,18 +18,105 @@ struct MemMgr_t
   uint8_t                   		nAlign;
   uint8_t                  			nAlignMask;
   uint32_t           				nFreeSum;
-  uint32_t							nAddrStart;
+  uintptr_t							nAddrStart;
+  uintptr_t							nAddrEnd;
 
   struct MemBlock_t* 				pFreeBlockList;
+#if MEM_CFG_STATS
+  struct Mem_Stats_t				sStats;
+#endif
 };
 
-static struct MemMgr_t g_sMemMgr = {0};
+static struct MemMgr_t g_sMemMgr[MEM_REGION_NUM] = {0};
+
+/*
+*********************************************************************************************************
+* Description	: These functions lock and unlock the shared heap.
+*
+* Arguments  	: None.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) only the multi-threaded host build (MEM_CFG_THREAD_CACHE) needs the lock, the blocks
+*					  cached by each thread are handled without it, see mem_mallocCached().
+*
+*********************************************************************************************************
+*/
+#if MEM_CFG_THREAD_CACHE
+static pthread_mutex_t g_sMemLock = PTHREAD_MUTEX_INITIALIZER;
+#define __mem_lock()						pthread_mutex_lock(&g_sMemLock)
+#define __mem_unlock()						pthread_mutex_unlock(&g_sMemLock)
+#else
+#define __mem_lock()
+#define __mem_unlock()
+#endif
+
+/*
+*********************************************************************************************************
+* Description	: this function find the region that the memory belongs to.
+*
+* Arguments  	: nAddr						Address of memory (the space returned to user).
+*
+* Return		: return pointer of region manager or NULL if the memory is not in any Memory Pool.
+*
+* Note(s)   	: (1) should be used in Mem_free() and Mem_relloc().
+*
+*********************************************************************************************************
+*/
+static struct MemMgr_t *mem_getRegionOfAddr(uintptr_t nAddr)
+{
+	uint8_t m;
+
+	for(m=0; m<MEM_REGION_NUM; m++)
+	{
+		if((nAddr >= g_sMemMgr[m].nAddrStart + sizeof(struct MemBlock_t)) && (nAddr < g_sMemMgr[m].nAddrEnd))
+		{
+			return &g_sMemMgr[m];
+		}
+	}
+	return NULL;
+}
+
+#if MEM_CFG_STATS
+/*
+*********************************************************************************************************
+* Description	: this function record one malloc to the statistics of region.
+*
+* Arguments  	: pMgr						Region manager that malloc from.
+*				  nSize						Size of memory user needs.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) only counters are updated here, the free block figures are walked in Mem_getStats().
+*
+*********************************************************************************************************
+*/
+static void mem_recordMalloc(struct MemMgr_t *pMgr, uint32_t nSize)
+{
+	uint32_t used_cur = (uint32_t)(pMgr->nAddrEnd - pMgr->nAddrStart) - pMgr->nFreeSum;
+	uint32_t size_bin = (nSize - 1) >> 3;
+	uint8_t m = 0;
+
+	while((size_bin != 0) && (m < MEM_STATS_HISTNUM - 1))
+	{
+		size_bin >>= 1;
+		m ++;
+	}
+	(pMgr->sStats.arrSizeHist[m]) ++;
+	(pMgr->sStats.nMallocCnt) ++;
+	if(used_cur > pMgr->sStats.nUsedPeak)
+	{
+		pMgr->sStats.nUsedPeak = used_cur;
+	}
+}
+#endif
 
 /*
 *********************************************************************************************************
 * Description	: this function  pop the need block from the free block list.
 *
-* Arguments  	: pElement					the block that needed.
+* Arguments  	: pMgr						Region manager that owns the block.
+*			      pElement					the block that needed.
 *			      nSizeNeed					Size of block.
 *
 * Return		: None.
@@ -35,31 +125,31 @@ static struct MemMgr_t g_sMemMgr = {0};
 *
 *********************************************************************************************************
 */
-static void mem_popFreeBlockList(struct MemBlock_t *pElement, uint32_t nSizeNeed)
+static void mem_popFreeBlockList(struct MemMgr_t *pMgr, struct MemBlock_t *pElement, uint32_t nSizeNeed)
 {
 	struct MemBlock_t *block_next = pElement->pNext;
 	struct MemBlock_t *block_pre = pElement->pPre;
 	uint32_t size_left = pElement->nFree - nSizeNeed;
 
-	if(size_left < g_sMemMgr.nAlign + sizeof(struct MemBlock_t)) // this free block only left space that not enough for next malloc, so remove whole block.
+	if(size_left < pMgr->nAlign + sizeof(struct MemBlock_t)) // this free block only left space that not enough for next malloc, so remove whole block.
 	{
-		g_sMemMgr.nFreeSum -= pElement->nFree;
+		pMgr->nFreeSum -= pElement->nFree;
 
 		if(block_pre != NULL) block_pre->pNext = block_next;
-		else g_sMemMgr.pFreeBlockList = block_next;
+		else pMgr->pFreeBlockList = block_next;
 		if(block_next != NULL) block_next->pPre = block_pre;
 	}
 	else // this free block left space that enough for next malloc, so resize the block.
 	{
-    g_sMemMgr.nFreeSum -= nSizeNeed;
+    pMgr->nFreeSum -= nSizeNeed;
     pElement->nFree = nSizeNeed;
 
-    struct MemBlock_t *block_new = (struct MemBlock_t *)((uint32_t)pElement + nSizeNeed);
+    struct MemBlock_t *block_new = (struct MemBlock_t *)((uintptr_t)pElement + nSizeNeed);
     block_new->nFree = size_left;
     block_new->pPre = block_pre;
     block_new->pNext = block_next;
     if(block_pre != NULL) block_pre->pNext = block_new;
-    else g_sMemMgr.pFreeBlockList = block_new;
+    else pMgr->pFreeBlockList = block_new;
     if(block_next != NULL) block_next->pPre = block_new;
 	}
 }
@@ -68,7 +158,8 @@ static void mem_popFreeBlockList(struct MemBlock_t *pElement, uint32_t nSizeNeed
 *********************************************************************************************************
 * Description	: this function  push the block to free block list.
 *
-* Arguments  	: pElement					the block that push back.
+* Arguments  	: pMgr						Region manager that owns the block.
+*			      pElement					the block that push back.
 *			 	  nSizeNeed					Size of the block.
 *
 * Return	    : None.
@@ -77,11 +168,13 @@ static void mem_popFreeBlockList(struct MemBlock_t *pElement, uint32_t nSizeNeed
 *
 *********************************************************************************************************
 */
-static void mem_pushFreeBlockList(struct MemBlock_t *pElement)
+static void mem_pushFreeBlockList(struct MemMgr_t *pMgr, struct MemBlock_t *pElement)
 {
-	struct MemBlock_t *block_next = g_sMemMgr.pFreeBlockList;
+	struct MemBlock_t *block_next = pMgr->pFreeBlockList;
 	struct MemBlock_t *block_pre = NULL;
-	while((block_next != NULL) && ((uint32_t)block_next < (uint32_t)pElement)) // used block list should be in order by address.
+
+	pMgr->nFreeSum += pElement->nFree;
+	while((block_next != NULL) && ((uintptr_t)block_next < (uintptr_t)pElement)) // used block list should be in order by address.
 	{
 		block_pre = block_next;
 		block_next = block_next->pNext;
@@ -91,7 +184,7 @@ static void mem_pushFreeBlockList(struct MemBlock_t *pElement)
 	pElement->pNext = block_next;
 	if((block_next == NULL) && (block_pre == NULL)) // the free list is empty.
 	{
-		g_sMemMgr.pFreeBlockList = pElement;
+		pMgr->pFreeBlockList = pElement;
 	}
 	else
 	{
@@ -99,7 +192,7 @@ static void mem_pushFreeBlockList(struct MemBlock_t *pElement)
 		{
 
 		}
-		else if((uint32_t)pElement + pElement->nFree == (uint32_t)block_next) // element can combile with the next block.
+		else if((uintptr_t)pElement + pElement->nFree == (uintptr_t)block_next) // element can combile with the next block.
 		{
 			pElement->nFree += block_next->nFree;
 			pElement->pNext = block_next->pNext;
@@ -111,9 +204,9 @@ static void mem_pushFreeBlockList(struct MemBlock_t *pElement)
 
 		if(block_pre == NULL) // element push to the head of list.
 		{
-			g_sMemMgr.pFreeBlockList = pElement;
+			pMgr->pFreeBlockList = pElement;
 		}
-		else if((uint32_t)block_pre + block_pre->nFree == (uint32_t)pElement) // element can combile with the pre block.
+		else if((uintptr_t)block_pre + block_pre->nFree == (uintptr_t)pElement) // element can combile with the pre block.
 		{
 			block_pre->nFree += pElement->nFree;
 			block_pre->pNext = pElement->pNext;
@@ -135,34 +228,62 @@ static void mem_pushFreeBlockList(struct MemBlock_t *pElement)
 *
 * Return	    : return (0) if init success or (-1) if not.
 *
-* Note(s)   	: None.
+* Note(s)   	: (1) the pool is taken as MEM_REGION_Slow, use Mem_initRegion() to add a fast region.
+*********************************************************************************************************
+*/
+int Mem_init(uintptr_t nAddr, uint32_t nSize, uint8_t nAlign)
+{
+	return Mem_initRegion(MEM_REGION_Slow, nAddr, nSize, nAlign);
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function takes the memory with user-design start address and size as one region of
+*				  Memory Pool.
+*
+* Arguments  	: eRegion					Region of Memory Pool, see enum Mem_Region_e.
+*			  	  nAddr						Start address of region.
+*			  	  nSize						Size of region.
+*			  	  nAlign					Align bytes of region.
+*
+* Return	    : return (0) if init success or (-1) if not.
+*
+* Note(s)   	: (1) each region is managed by its own free block list, regions should not overlap.
 *********************************************************************************************************
 */
-int Mem_init(uint32_t nAddr, uint32_t nSize, uint8_t nAlign)
+int Mem_initRegion(enum Mem_Region_e eRegion, uintptr_t nAddr, uint32_t nSize, uint8_t nAlign)
 {
-	uint32_t addr_start = nAddr;
+	struct MemMgr_t *mgr;
+	uintptr_t addr_start = nAddr;
+
+	if(eRegion >= MEM_REGION_NUM) return -1;
+	mgr = &g_sMemMgr[eRegion];
 
 	memset((void *)addr_start, 0, nSize);
-	g_sMemMgr.nAlign = (nAlign == 0)? sizeof(uint32_t): nAlign;
-	g_sMemMgr.nAlignMask = g_sMemMgr.nAlign - 1;
+	mgr->nAlign = (nAlign == 0)? sizeof(uint32_t): nAlign;
+	mgr->nAlignMask = mgr->nAlign - 1;
 
-	if(addr_start & g_sMemMgr.nAlignMask) // make sure the address is aligned.
+	if(addr_start & mgr->nAlignMask) // make sure the address is aligned.
 	{
-		addr_start += g_sMemMgr.nAlignMask;
-		addr_start &= ~g_sMemMgr.nAlignMask;
-		nSize = (nSize < addr_start - nAddr)? 0: nSize - (addr_start - nAddr);
+		addr_start += mgr->nAlignMask;
+		addr_start &= ~mgr->nAlignMask;
+		nSize = (nSize < addr_start - nAddr)? 0: nSize - (uint32_t)(addr_start - nAddr);
 	}
-	if(nSize >= g_sMemMgr.nAlign)
+	if(nSize >= mgr->nAlign)
 	{
-		uint32_t addr_end = addr_start + nSize;
-		addr_end &= ~g_sMemMgr.nAlignMask;
-		g_sMemMgr.nAddrStart = addr_start;
-		g_sMemMgr.nFreeSum = addr_end - addr_start;
-		/* the first free block starts as the whole block of Memory Pool. */
-		g_sMemMgr.pFreeBlockList = (void *)addr_start;
-		g_sMemMgr.pFreeBlockList->nFree = g_sMemMgr.nFreeSum;
-		g_sMemMgr.pFreeBlockList->pPre = NULL;
-		g_sMemMgr.pFreeBlockList->pNext = NULL;
+		uintptr_t addr_end = addr_start + nSize;
+		addr_end &= ~mgr->nAlignMask;
+		mgr->nAddrStart = addr_start;
+		mgr->nAddrEnd = addr_end;
+		mgr->nFreeSum = (uint32_t)(addr_end - addr_start);
+		/* the first free block starts as the whole block of region. */
+		mgr->pFreeBlockList = (void *)addr_start;
+		mgr->pFreeBlockList->nFree = mgr->nFreeSum;
+		mgr->pFreeBlockList->pPre = NULL;
+		mgr->pFreeBlockList->pNext = NULL;
+#if MEM_CFG_STATS
+		memset(&mgr->sStats, 0, sizeof(struct Mem_Stats_t));
+#endif
 
 		return 0;
 	}
@@ -171,41 +292,231 @@ int Mem_init(uint32_t nAddr, uint32_t nSize, uint8_t nAlign)
 
 /*
 *********************************************************************************************************
-* Description	: this function malloc a memory.
+* Description	: this function get the size of block needed for the memory user needs.
 *
-* Arguments  	: nSize						Size of memory user needs.
+* Arguments  	: pMgr						Region manager to malloc from.
+*				  nSize						Size of memory user needs.
 *
-* Return		: None.
+* Return		: return size of block (block head included).
 *
 * Note(s)   	: None.
 *********************************************************************************************************
 */
-void* Mem_malloc(uint32_t nSize)
+static uint32_t mem_getBlockSize(struct MemMgr_t *pMgr, uint32_t nSize)
 {
-	struct MemBlock_t *block_need;
-
-	if(nSize == 0) return NULL;
-	if(g_sMemMgr.pFreeBlockList == NULL)  return NULL;
-
 	nSize += sizeof(struct MemBlock_t); // each block contains a MemBlock_t struct to manage this block.
-	if(nSize & g_sMemMgr.nAlignMask)
+	if(nSize & pMgr->nAlignMask)
 	{
-	nSize += g_sMemMgr.nAlignMask;
-	nSize &= ~g_sMemMgr.nAlignMask;
+	nSize += pMgr->nAlignMask;
+	nSize &= ~pMgr->nAlignMask;
 	}
+	return nSize;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function malloc a memory from one region.
+*
+* Arguments  	: pMgr						Region manager to malloc from.
+*				  nSize						Size of memory user needs.
+*
+* Return		: return address of memory or NULL if the region has no free block large enough.
+*
+* Note(s)   	: None.
+*********************************************************************************************************
+*/
+static void* mem_mallocFrom(struct MemMgr_t *pMgr, uint32_t nSize)
+{
+	struct MemBlock_t *block_need;
+	uint32_t size_user = nSize;
+
+	if(pMgr->pFreeBlockList == NULL)  return NULL;
+
+	nSize = mem_getBlockSize(pMgr, nSize);
 
-	block_need = g_sMemMgr.pFreeBlockList;
+	block_need = pMgr->pFreeBlockList;
 	while((block_need != NULL) && (block_need->nFree < nSize)) // find the free block that large enough.
 	{
 		block_need = block_need->pNext;
 	}
 	if(block_need == NULL) return NULL;
-	mem_popFreeBlockList(block_need, nSize);
+	mem_popFreeBlockList(pMgr, block_need, nSize);
 	//mem_pushUsedBlockList(block_need);
+#if MEM_CFG_STATS
+	mem_recordMalloc(pMgr, size_user);
+#endif
 
 	return (void *)&(block_need[1]); // return the space, (block head is not included).
 }
 
+/*
+*********************************************************************************************************
+* Description	: this function malloc a memory.
+*
+* Arguments  	: nSize						Size of memory user needs.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) bulk buffers go to MEM_REGION_Slow first, see Mem_mallocIn().
+*********************************************************************************************************
+*/
+void* Mem_malloc(uint32_t nSize)
+{
+	return Mem_mallocIn(MEM_REGION_Slow, nSize);
+}
+
+#if MEM_CFG_THREAD_CACHE
+struct MemCache_t
+{
+  struct MemBlock_t* 				pBlockList;						// List of cached blocks, linked by pNext.
+  uint32_t							nCnt;							// Number of cached blocks.
+};
+
+static __thread struct MemCache_t s_arrMemCache[MEM_REGION_NUM][MEM_CACHE_CLASSNUM];
+
+/*
+*********************************************************************************************************
+* Description	: this function malloc a memory from the cache of calling thread.
+*
+* Arguments  	: eRegion					Region preferred, see enum Mem_Region_e.
+*				  nSize						Size of memory user needs.
+*
+* Return		: return address of memory or NULL if the size is not cached or the region is full.
+*
+* Note(s)   	: (1) no lock is taken unless the cache is empty, then MEM_CACHE_BATCH blocks of the size
+*					  class are refilled from the shared heap under one lock.
+*
+*********************************************************************************************************
+*/
+static void* mem_mallocCached(enum Mem_Region_e eRegion, uint32_t nSize)
+{
+	struct MemCache_t *cache;
+	struct MemBlock_t *block_need;
+	uint8_t m = 0;
+
+	while((m < MEM_CACHE_CLASSNUM) && (nSize > ((uint32_t)16 << m)))
+	{
+		m ++;
+	}
+	if(m == MEM_CACHE_CLASSNUM) return NULL;
+
+	cache = &s_arrMemCache[eRegion][m];
+	if(cache->pBlockList == NULL)
+	{
+		uint8_t n;
+		__mem_lock();
+		for(n=0; n<MEM_CACHE_BATCH; n++)
+		{
+			void *mem_new = mem_mallocFrom(&g_sMemMgr[eRegion], (uint32_t)16 << m);
+			if(mem_new == NULL) break;
+			block_need = (struct MemBlock_t *)mem_new - 1;
+			block_need->pNext = cache->pBlockList;
+			cache->pBlockList = block_need;
+			(cache->nCnt) ++;
+		}
+		__mem_unlock();
+		if(cache->pBlockList == NULL) return NULL;
+	}
+	block_need = cache->pBlockList;
+	cache->pBlockList = block_need->pNext;
+	(cache->nCnt) --;
+
+	return (void *)&(block_need[1]);
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function free a block to the cache of calling thread.
+*
+* Arguments  	: pMgr						Region manager that owns the block.
+*				  pElement					the block to free.
+*
+* Return		: return (0) if cached or (-1) if the block is not of any size class.
+*
+* Note(s)   	: (1) when the cache holds more than MEM_CACHE_MAXCNT blocks, MEM_CACHE_BATCH of them are
+*					  flushed back to the shared heap under one lock.
+*
+*********************************************************************************************************
+*/
+static int mem_freeCached(struct MemMgr_t *pMgr, struct MemBlock_t *pElement)
+{
+	struct MemCache_t *cache;
+	uint8_t m = 0;
+
+	while((m < MEM_CACHE_CLASSNUM) && (pElement->nFree != mem_getBlockSize(pMgr, (uint32_t)16 << m)))
+	{
+		m ++;
+	}
+	if(m == MEM_CACHE_CLASSNUM) return -1;
+
+	cache = &s_arrMemCache[pMgr - g_sMemMgr][m];
+	pElement->pNext = cache->pBlockList;
+	cache->pBlockList = pElement;
+	(cache->nCnt) ++;
+	if(cache->nCnt > MEM_CACHE_MAXCNT)
+	{
+		uint8_t n;
+		__mem_lock();
+		for(n=0; n<MEM_CACHE_BATCH; n++)
+		{
+			struct MemBlock_t *block_cur = cache->pBlockList;
+			cache->pBlockList = block_cur->pNext;
+			mem_pushFreeBlockList(pMgr, block_cur);
+#if MEM_CFG_STATS
+			(pMgr->sStats.nFreeCnt) ++;
+#endif
+		}
+		cache->nCnt -= MEM_CACHE_BATCH;
+		__mem_unlock();
+	}
+	return 0;
+}
+#endif
+
+/*
+*********************************************************************************************************
+* Description	: this function malloc a memory from the region that user prefers.
+*
+* Arguments  	: eRegion					Region preferred, see enum Mem_Region_e.
+*				  nSize						Size of memory user needs.
+*
+* Return		: return address of memory or NULL if no region has enough space.
+*
+* Note(s)   	: (1) placement policy: try the preferred region first, if it is not inited or is full,
+*					  fall back to the other regions in order, so a board with only one region still works.
+*********************************************************************************************************
+*/
+void* Mem_mallocIn(enum Mem_Region_e eRegion, uint32_t nSize)
+{
+	void *ret_memory;
+	uint8_t m;
+
+	if(nSize == 0) return NULL;
+	if(eRegion >= MEM_REGION_NUM) eRegion = MEM_REGION_Slow;
+
+#if MEM_CFG_THREAD_CACHE
+	ret_memory = mem_mallocCached(eRegion, nSize);
+	if(ret_memory != NULL) return ret_memory;
+#endif
+	__mem_lock();
+	ret_memory = mem_mallocFrom(&g_sMemMgr[eRegion], nSize);
+	for(m=0; (ret_memory == NULL) && (m<MEM_REGION_NUM); m++)
+	{
+		if(m != eRegion)
+		{
+			ret_memory = mem_mallocFrom(&g_sMemMgr[m], nSize);
+		}
+	}
+#if MEM_CFG_STATS
+	if(ret_memory == NULL) // failure is recorded by the preferred region.
+	{
+		(g_sMemMgr[eRegion].sStats.nFailCnt) ++;
+	}
+#endif
+	__mem_unlock();
+	return ret_memory;
+}
+
 /*
 *********************************************************************************************************
 * Description	: this function free a memory.
@@ -214,18 +525,28 @@ void* Mem_malloc(uint32_t nSize)
 *
 * Return		: None.
 *
-* Note(s)   	: None.
+* Note(s)   	: (1) the block is given back to the region it comes from (or to the cache of calling thread
+*					  if MEM_CFG_THREAD_CACHE is enabled).
 *********************************************************************************************************
 */
 void Mem_free(void *pMemory)
 {
 	struct MemBlock_t *block_need;
-	if((uint32_t)pMemory < g_sMemMgr.nAddrStart + sizeof(struct MemBlock_t)) // the memory is not in the Memory Pool.
+	struct MemMgr_t *mgr = mem_getRegionOfAddr((uintptr_t)pMemory);
+	if(mgr == NULL) // the memory is not in the Memory Pool.
 		return;
 
-	block_need = (struct MemBlock_t *)((uint32_t)pMemory - sizeof(struct MemBlock_t));
+	block_need = (struct MemBlock_t *)((uintptr_t)pMemory - sizeof(struct MemBlock_t));
 	//mem_popUsedBlockList(block_need);
-	mem_pushFreeBlockList(block_need);
+#if MEM_CFG_THREAD_CACHE
+	if(mem_freeCached(mgr, block_need) == 0) return;
+#endif
+	__mem_lock();
+	mem_pushFreeBlockList(mgr, block_need);
+#if MEM_CFG_STATS
+	(mgr->sStats.nFreeCnt) ++;
+#endif
+	__mem_unlock();
 }
 
 /*
@@ -240,9 +561,26 @@ void Mem_free(void *pMemory)
 *********************************************************************************************************
 */
 void *Mem_calloc(uint32_t nSize)
+{
+  return Mem_callocIn(MEM_REGION_Slow, nSize);
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function calloc a memory from the region that user prefers.
+*
+* Arguments  	: eRegion						Region preferred, see enum Mem_Region_e.
+*				  nSize							Size of memory needed to calloc.
+*
+* Return		: return address of memory or NULL if no region has enough space.
+*
+* Note(s)   	: (1) see Mem_mallocIn() for the placement policy.
+*********************************************************************************************************
+*/
+void *Mem_callocIn(enum Mem_Region_e eRegion, uint32_t nSize)
 {
   void *ret_memory;
-  ret_memory = Mem_malloc(nSize);
+  ret_memory = Mem_mallocIn(eRegion, nSize);
   if(ret_memory != NULL)
   {
     memset(ret_memory, 0, nSize);
@@ -259,21 +597,22 @@ void *Mem_calloc(uint32_t nSize)
 *
 * Return		: return address of memory.
 *
-* Note(s)   	: None.
+* Note(s)   	: (1) the new memory prefers the same region as the original one.
 *********************************************************************************************************
 */
 void* Mem_relloc(void *nMemory, uint32_t nSize)
 {
 	void *memory_ret = NULL;
+	struct MemMgr_t *mgr = mem_getRegionOfAddr((uintptr_t)nMemory);
 
-	if((uint32_t)nMemory < g_sMemMgr.nAddrStart + sizeof(struct MemBlock_t)) // the memory is not in the Memory Pool.
+	if(mgr == NULL) // the memory is not in the Memory Pool.
 		return NULL;
 
-	struct MemBlock_t *block_original = (struct MemBlock_t *)((uint32_t) nMemory - sizeof(struct MemBlock_t));
+	struct MemBlock_t *block_original = (struct MemBlock_t *)((uintptr_t)nMemory - sizeof(struct MemBlock_t));
 	uint32_t size_original = block_original->nFree;
 	uint32_t size_copy = (size_original > nSize)? nSize: size_original;
 
-	memory_ret = Mem_malloc(size_original);
+	memory_ret = Mem_mallocIn((enum Mem_Region_e)(mgr - g_sMemMgr), size_original);
 	if(memory_ret != NULL)
 	{
 		memmove(memory_ret, nMemory, size_copy);
@@ -290,14 +629,126 @@ void* Mem_relloc(void *nMemory, uint32_t nSize)
 *
 * Arguments  	: None.
 *
-* Return		: return free size.
+* Return		: return free size of all regions.
 *
 * Note(s)   	: None.
 *********************************************************************************************************
 */
-uint32_t Memory_getFreeSize(void)
+uint32_t Mem_getFreeSize(void)
 {
-  return g_sMemMgr.nFreeSum;
+  uint32_t free_sum = 0;
+  uint8_t m;
+
+  for(m=0; m<MEM_REGION_NUM; m++)
+  {
+    free_sum += g_sMemMgr[m].nFreeSum;
+  }
+  return free_sum;
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function get the statistics of heap.
+*
+* Arguments  	: eRegion						Region to get, MEM_REGION_NUM means the sum of all regions.
+*				  pStats						Pointer of struct to store the statistics.
+*
+* Return		: return (0) if success or (-1) if not.
+*
+* Note(s)   	: (1) the counters are updated while malloc and free, only the free block figures are got by
+*					  walking the free block list here, so the cost of statistics is paid by the caller.
+*
+*				  (2) when summing all regions, nUsedPeak is the sum of peak of each region.
+*
+*				  (3) with MEM_CFG_THREAD_CACHE, blocks in thread caches are counted as in use, and the
+*					  counters count the blocks refilled from and flushed to the shared heap.
+*********************************************************************************************************
+*/
+int Mem_getStats(enum Mem_Region_e eRegion, struct Mem_Stats_t *pStats)
+{
+#if MEM_CFG_STATS
+	uint8_t m, n;
+
+	if((pStats == NULL) || (eRegion > MEM_REGION_NUM)) return -1;
+
+	memset(pStats, 0, sizeof(struct Mem_Stats_t));
+	__mem_lock();
+	for(m=0; m<MEM_REGION_NUM; m++)
+	{
+		struct MemMgr_t *mgr = &g_sMemMgr[m];
+		struct MemBlock_t *block_cur = mgr->pFreeBlockList;
+
+		if((eRegion != MEM_REGION_NUM) && (eRegion != m)) continue;
+
+		pStats->nUsedCur += (uint32_t)(mgr->nAddrEnd - mgr->nAddrStart) - mgr->nFreeSum;
+		pStats->nUsedPeak += mgr->sStats.nUsedPeak;
+		pStats->nFreeSum += mgr->nFreeSum;
+		pStats->nMallocCnt += mgr->sStats.nMallocCnt;
+		pStats->nFreeCnt += mgr->sStats.nFreeCnt;
+		pStats->nFailCnt += mgr->sStats.nFailCnt;
+		for(n=0; n<MEM_STATS_HISTNUM; n++)
+		{
+			pStats->arrSizeHist[n] += mgr->sStats.arrSizeHist[n];
+		}
+		while(block_cur != NULL)
+		{
+			(pStats->nFreeBlockCnt) ++;
+			if(block_cur->nFree > pStats->nFreeBlockMax)
+			{
+				pStats->nFreeBlockMax = block_cur->nFree;
+			}
+			block_cur = block_cur->pNext;
+		}
+	}
+	__mem_unlock();
+	if(pStats->nFreeSum > 0)
+	{
+		pStats->nFragRatio = 100 - (uint8_t)(((uint64_t)pStats->nFreeBlockMax * 100) / pStats->nFreeSum);
+	}
+	return 0;
+#else
+	return -1;
+#endif
+}
+
+/*
+*********************************************************************************************************
+* Description	: this function flush all blocks cached by calling thread back to the shared heap.
+*
+* Arguments  	: None.
+*
+* Return		: None.
+*
+* Note(s)   	: (1) call it before a worker thread exits, otherwise its cached blocks are lost.
+*
+*				  (2) do nothing if MEM_CFG_THREAD_CACHE is disabled.
+*********************************************************************************************************
+*/
+void Mem_flushThreadCache(void)
+{
+#if MEM_CFG_THREAD_CACHE
+	uint8_t m, n;
+
+	__mem_lock();
+	for(m=0; m<MEM_REGION_NUM; m++)
+	{
+		for(n=0; n<MEM_CACHE_CLASSNUM; n++)
+		{
+			struct MemCache_t *cache = &s_arrMemCache[m][n];
+			while(cache->pBlockList != NULL)
+			{
+				struct MemBlock_t *block_cur = cache->pBlockList;
+				cache->pBlockList = block_cur->pNext;
+				mem_pushFreeBlockList(&g_sMemMgr[m], block_cur);
+#if MEM_CFG_STATS
+				(g_sMemMgr[m].sStats.nFreeCnt) ++;
+#endif
+			}
+			cache->nCnt = 0;
+		}
+	}
+	__mem_unlock();
+#endif
 }
 
 /*
@@ -351,7 +802,7 @@ int Mem_test(void)
   mem1 = Mem_malloc(7);
   Mem_free(mem1);
   mem2 = Mem_malloc(7);
-  if((uint32_t)mem1 != (uint32_t)mem2)
+  if((uintptr_t)mem1 != (uintptr_t)mem2)
   {
     return -1;
   }
@@ -364,7 +815,7 @@ int Mem_test(void)
   mem2 = Mem_malloc(SIZE1);
   Mem_free(mem1);
   mem3 = Mem_malloc(SIZE1);
-  if((uint32_t)mem1 != (uint32_t)mem3)
+  if((uintptr_t)mem1 != (uintptr_t)mem3)
   {
     return -2;
   }
@@ -374,7 +825,7 @@ int Mem_test(void)
   mem2 = Mem_malloc(SIZE1);
   Mem_free(mem1);
   mem3 = Mem_malloc(SIZE2);
-  if((uint32_t)mem3 != (uint32_t)mem2 + (((SIZE1+sizeof(struct MemBlock_t))/g_sMemMgr.nAlign)+1)*g_sMemMgr.nAlign)
+  if((uintptr_t)mem3 != (uintptr_t)mem2 + (((SIZE1+sizeof(struct MemBlock_t))/g_sMemMgr[MEM_REGION_Slow].nAlign)+1)*g_sMemMgr[MEM_REGION_Slow].nAlign)
   {
     return -3;
   }
@@ -389,13 +840,13 @@ int Mem_test(void)
   Mem_free(mem2);
   Mem_free(mem3);
   mem5 = Mem_malloc(15);
-  if((uint32_t)mem2 != (uint32_t)mem5)
+  if((uintptr_t)mem2 != (uintptr_t)mem5)
   {
     return -4;
   }
   Mem_free(mem5);
   mem5 = Mem_malloc(48);
-  if((uint32_t)mem2 == (uint32_t)mem5)
+  if((uintptr_t)mem2 == (uintptr_t)mem5)
   {
     return -5;
   }
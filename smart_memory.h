@@ -3,12 +3,53 @@
 
 #include <stdint.h>
 
-int Mem_init(uint32_t nAddr, uint32_t nSize, uint8_t nAlign);
+#ifndef MEM_CFG_STATS
+#define MEM_CFG_STATS				1			// Enable heap statistics, cost is a few counters per malloc and free.
+#endif
+#define MEM_STATS_HISTNUM			12			// Number of bins of allocation size histogram.
+
+#ifndef MEM_CFG_THREAD_CACHE
+#define MEM_CFG_THREAD_CACHE		0			// Enable per-thread block caches for multi-threaded host build (pthread).
+#endif
+#define MEM_CACHE_CLASSNUM			5			// Number of size classes, class m caches size <= (16 << m).
+#define MEM_CACHE_BATCH				8			// Number of blocks refilled from or flushed to heap at once.
+#define MEM_CACHE_MAXCNT			32			// Max number of blocks cached per class in each thread.
+
+enum Mem_Region_e
+{
+	MEM_REGION_Fast = 0,		// small fast ram (such as TCM or internal SRAM), used for hot objects.
+	MEM_REGION_Slow,			// large slow ram (such as external SDRAM), used for bulk buffers.
+
+	MEM_REGION_NUM,
+};
+
+struct Mem_Stats_t
+{
+	uint32_t					nUsedCur;									// Bytes in use now (block head included).
+	uint32_t					nUsedPeak;									// Max bytes in use ever.
+	uint32_t					nFreeSum;									// Bytes free now.
+	uint32_t					nFreeBlockCnt;								// Number of free blocks.
+	uint32_t					nFreeBlockMax;								// Size of the largest free block.
+	uint8_t						nFragRatio;									// Fragmentation percentage, 100 - 100 * nFreeBlockMax / nFreeSum.
+	uint32_t					nMallocCnt;									// Number of malloc succeeded.
+	uint32_t					nFreeCnt;									// Number of free.
+	uint32_t					nFailCnt;									// Number of malloc failed.
+	uint32_t					arrSizeHist[MEM_STATS_HISTNUM];				// Histogram of size user mallocs, bin 0 counts
+																			// size <= 8, bin m counts size in (2^(m+2), 2^(m+3)],
+																			// the last bin counts all larger size.
+};
+
+int Mem_init(uintptr_t nAddr, uint32_t nSize, uint8_t nAlign);
+int Mem_initRegion(enum Mem_Region_e eRegion, uintptr_t nAddr, uint32_t nSize, uint8_t nAlign);
 void* Mem_malloc(uint32_t nSize);
+void* Mem_mallocIn(enum Mem_Region_e eRegion, uint32_t nSize);
 void Mem_free(void *pMemory);
 void *Mem_calloc(uint32_t nSize);
+void *Mem_callocIn(enum Mem_Region_e eRegion, uint32_t nSize);
 void *Mem_relloc(void* pMemory, uint32_t nSize);
 uint32_t Mem_getFreeSize(void);
+int Mem_getStats(enum Mem_Region_e eRegion, struct Mem_Stats_t *pStats);
+void Mem_flushThreadCache(void);
 int Mem_test(void);
 
 #endif